@@ -5,11 +5,17 @@
 #include <string.h>
 #include <time.h>
 
+#include "../../common/crypto_arena.h"
+
 // Defines for AES-128
 #define Nk 4
 #define Nb 4
 #define Nr 10
 #define AES_BLOCK_SIZE 16
+#define AES_ROUND_KEY_SIZE (AES_BLOCK_SIZE * (Nr + 1))
+
+// Round keys padded to whole cache lines so no schedule straddles two lanes
+#define AES_ROUND_KEY_STRIDE ((AES_ROUND_KEY_SIZE + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
 
 // AES S-box
 static const uint8_t s_box[256] = {
@@ -85,23 +91,29 @@ void SubBytes(state_t *s)
 }
 
 #ifdef USE_RISCV_ACCEL
+// rori rotates the whole register; RV64 needs the 32-bit word form
+#if __riscv_xlen == 64
+#define RORI32 "roriw"
+#else
+#define RORI32 "rori"
+#endif
 void ShiftRows(state_t *s)
 {
     uint32_t r1, r2, r3;
     r1 = ((*s)[1][0] << 24) | ((*s)[1][1] << 16) | ((*s)[1][2] << 8) | (*s)[1][3];
-    asm volatile("rori %0,%1,24" : "=r"(r1) : "r"(r1));
+    asm volatile(RORI32 " %0,%1,24" : "=r"(r1) : "r"(r1));
     (*s)[1][0] = r1 >> 24;
     (*s)[1][1] = r1 >> 16;
     (*s)[1][2] = r1 >> 8;
     (*s)[1][3] = r1;
     r2 = ((*s)[2][0] << 24) | ((*s)[2][1] << 16) | ((*s)[2][2] << 8) | (*s)[2][3];
-    asm volatile("rori %0,%1,16" : "=r"(r2) : "r"(r2));
+    asm volatile(RORI32 " %0,%1,16" : "=r"(r2) : "r"(r2));
     (*s)[2][0] = r2 >> 24;
     (*s)[2][1] = r2 >> 16;
     (*s)[2][2] = r2 >> 8;
     (*s)[2][3] = r2;
     r3 = ((*s)[3][0] << 24) | ((*s)[3][1] << 16) | ((*s)[3][2] << 8) | (*s)[3][3];
-    asm volatile("rori %0,%1,8" : "=r"(r3) : "r"(r3));
+    asm volatile(RORI32 " %0,%1,8" : "=r"(r3) : "r"(r3));
     (*s)[3][0] = r3 >> 24;
     (*s)[3][1] = r3 >> 16;
     (*s)[3][2] = r3 >> 8;
@@ -118,11 +130,11 @@ void MixColumns(state_t *s)
         asm volatile("clmul %0,%1,%2" : "=r"(b) : "r"(a), "r"(M3));
         t ^= b;
         b = a;
-        asm volatile("rori %0,%1,8" : "=r"(b) : "r"(b));
+        asm volatile(RORI32 " %0,%1,8" : "=r"(b) : "r"(b));
         t ^= b;
-        asm volatile("rori %0,%1,8" : "=r"(b) : "r"(b));
+        asm volatile(RORI32 " %0,%1,8" : "=r"(b) : "r"(b));
         t ^= b;
-        asm volatile("rori %0,%1,8" : "=r"(b) : "r"(b));
+        asm volatile(RORI32 " %0,%1,8" : "=r"(b) : "r"(b));
         t ^= b;
         (*s)[0][i] = t;
         (*s)[1][i] = t >> 8;
@@ -195,6 +207,77 @@ void state_to_block(const state_t *s, uint8_t *b)
             b[c * 4 + r] = (*s)[r][c];
 }
 
+/*****************************************************************************/
+/* ARENA-BACKED BATCH API                                                    */
+/*****************************************************************************/
+
+// Many AES-128 key schedules packed back to back in an arena, one
+// AES_ROUND_KEY_STRIDE slot per session
+typedef struct
+{
+    size_t count;
+    uint8_t (*round_key)[AES_ROUND_KEY_STRIDE];
+} aes_batch;
+
+// One unit of batched work: ECB-encrypt len bytes (a multiple of
+// AES_BLOCK_SIZE) from in to out with the key schedule of session ctx
+typedef struct
+{
+    size_t ctx;
+    const uint8_t *in;
+    uint8_t *out;
+    size_t len;
+} aes_job;
+
+// Carves count key schedule slots out of the arena. Returns 0 or -1.
+int aes_batch_init(aes_batch *batch, crypto_arena *arena, size_t count)
+{
+    batch->count = 0;
+    if (count > SIZE_MAX / sizeof(*batch->round_key))
+        return -1;
+
+    batch->round_key = arena_alloc(arena, count * sizeof(*batch->round_key));
+    if (!batch->round_key)
+        return -1;
+    batch->count = count;
+    return 0;
+}
+
+// Expands key into the schedule of session ctx. Returns -1 if ctx is outside
+// the batch.
+int aes_batch_set_key(aes_batch *batch, size_t ctx, const uint8_t *key)
+{
+    if (ctx >= batch->count)
+        return -1;
+    KeyExpansion(batch->round_key[ctx], key);
+    return 0;
+}
+
+// Encrypts every job with its session's key schedule. Returns -1 without
+// writing any output if a job names a session outside the batch or its length
+// is not a whole number of blocks (padding is left to the caller).
+int aes_batch_encrypt(const aes_batch *batch, const aes_job *jobs, size_t njobs)
+{
+    state_t state;
+    for (size_t j = 0; j < njobs; ++j)
+    {
+        if (jobs[j].ctx >= batch->count || jobs[j].len % AES_BLOCK_SIZE != 0)
+            return -1;
+    }
+
+    for (size_t j = 0; j < njobs; ++j)
+    {
+        const uint8_t *Rk = batch->round_key[jobs[j].ctx];
+        for (size_t off = 0; off < jobs[j].len; off += AES_BLOCK_SIZE)
+        {
+            block_to_state(jobs[j].in + off, &state);
+            aes_encrypt(&state, Rk);
+            state_to_block(&state, jobs[j].out + off);
+        }
+    }
+    return 0;
+}
+
 /*****************************************************************************/
 /* AUTOMATED BENCHMARKING SUITE                                              */
 /*****************************************************************************/
@@ -281,6 +364,146 @@ PerformanceResult run_benchmark_for_size(long long size, const uint8_t *RoundKey
     return result;
 }
 
+// Batch benchmark: each session expands its own key and encrypts one message,
+// either with a stack key schedule per call or as one slot of an aes_batch.
+#define BATCH_MSG_SIZE 1024
+#define BATCH_START_SESSIONS 64
+#define BATCH_END_SESSIONS 1024
+#define BATCH_STEP_SESSIONS 64
+
+// Fills result and returns 0, or returns -1 if the batch could not be set up
+// or its output differs from the per-call path.
+int run_batch_benchmark(size_t sessions, crypto_arena *arena, const uint8_t *keys, const uint8_t *messages,
+                        uint8_t *per_call_out, uint8_t *batch_out, BatchResult *result)
+{
+    aes_batch batch;
+    state_t state;
+
+    arena_reset(arena);
+    aes_job *jobs = arena_alloc(arena, sessions * sizeof(*jobs));
+    if (!jobs || aes_batch_init(&batch, arena, sessions) != 0)
+    {
+        fprintf(stderr, "ERROR: Arena too small for %zu sessions\n", sessions);
+        return -1;
+    }
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        jobs[i].ctx = i;
+        jobs[i].in = messages + i * BATCH_MSG_SIZE;
+        jobs[i].out = batch_out + i * BATCH_MSG_SIZE;
+        jobs[i].len = BATCH_MSG_SIZE;
+    }
+
+    // 1. Current path: key schedule on the stack per call
+    clock_t start = clock();
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        uint8_t RoundKey[AES_ROUND_KEY_SIZE];
+        KeyExpansion(RoundKey, keys + i * AES_BLOCK_SIZE);
+        for (size_t off = 0; off < BATCH_MSG_SIZE; off += AES_BLOCK_SIZE)
+        {
+            block_to_state(messages + i * BATCH_MSG_SIZE + off, &state);
+            aes_encrypt(&state, RoundKey);
+            state_to_block(&state, per_call_out + i * BATCH_MSG_SIZE + off);
+        }
+    }
+    clock_t end = clock();
+    result->per_call_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    // 2. Batched path over the pre-allocated arena
+    start = clock();
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        if (aes_batch_set_key(&batch, i, keys + i * AES_BLOCK_SIZE) != 0)
+        {
+            fprintf(stderr, "ERROR: Batch key set for a session outside the batch\n");
+            return -1;
+        }
+    }
+    if (aes_batch_encrypt(&batch, jobs, sessions) != 0)
+    {
+        fprintf(stderr, "ERROR: Batch job has a bad session index or partial block\n");
+        return -1;
+    }
+    end = clock();
+    result->batch_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    if (memcmp(per_call_out, batch_out, sessions * BATCH_MSG_SIZE) != 0)
+    {
+        fprintf(stderr, "ERROR: Batch ciphertext differs from per-call ciphertext at %zu sessions\n", sessions);
+        return -1;
+    }
+
+    return 0;
+}
+
+int run_batch_sweep(const char *csv_filename)
+{
+    crypto_arena arena;
+    size_t arena_size = BATCH_END_SESSIONS * (sizeof(aes_job) + AES_ROUND_KEY_STRIDE) + 2 * ARENA_ALIGN;
+    uint8_t *keys = malloc(BATCH_END_SESSIONS * AES_BLOCK_SIZE);
+    uint8_t *messages = malloc(BATCH_END_SESSIONS * BATCH_MSG_SIZE);
+    uint8_t *per_call_out = malloc(BATCH_END_SESSIONS * BATCH_MSG_SIZE);
+    uint8_t *batch_out = malloc(BATCH_END_SESSIONS * BATCH_MSG_SIZE);
+    if (!keys || !messages || !per_call_out || !batch_out || arena_init(&arena, arena_size) != 0)
+    {
+        perror("ERROR: Failed to allocate batch benchmark buffers");
+        free(keys);
+        free(messages);
+        free(per_call_out);
+        free(batch_out);
+        return 1;
+    }
+    for (size_t i = 0; i < BATCH_END_SESSIONS * AES_BLOCK_SIZE; ++i)
+        keys[i] = (i * 13 + 1) % 256;
+    for (size_t i = 0; i < BATCH_END_SESSIONS * BATCH_MSG_SIZE; ++i)
+        messages[i] = i % 256;
+
+    FILE *csv_file = fopen(csv_filename, "w");
+    if (!csv_file)
+    {
+        perror("ERROR: Could not open batch CSV file for writing");
+        arena_free(&arena);
+        free(keys);
+        free(messages);
+        free(per_call_out);
+        free(batch_out);
+        return 1;
+    }
+    fprintf(csv_file, "Sessions,PerCall_s,Batch_s,PerCall_SessionsPerSec,Batch_SessionsPerSec\n");
+
+    // Failed session counts are left out of the CSV and reported through the return value
+    int failed = 0;
+
+    for (size_t sessions = BATCH_START_SESSIONS; sessions <= BATCH_END_SESSIONS; sessions += BATCH_STEP_SESSIONS)
+    {
+        printf("Batch sessions: %zu\r", sessions);
+        fflush(stdout);
+
+        BatchResult result;
+        if (run_batch_benchmark(sessions, &arena, keys, messages, per_call_out, batch_out, &result) != 0)
+        {
+            failed = 1;
+            continue;
+        }
+
+        fprintf(csv_file, "%zu,%.6f,%.6f,%.0f,%.0f\n",
+                sessions,
+                result.per_call_time,
+                result.batch_time,
+                sessions_per_second(sessions, result.per_call_time),
+                sessions_per_second(sessions, result.batch_time));
+    }
+
+    fclose(csv_file);
+    arena_free(&arena);
+    free(keys);
+    free(messages);
+    free(per_call_out);
+    free(batch_out);
+    return failed;
+}
+
 int main()
 {
     const long long START_SIZE = 100 * 1024;     // 100 KB
@@ -288,16 +511,18 @@ int main()
     const long long STEP_SIZE = 100 * 1024;      // 100 KB
 
     uint8_t key[] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
-    uint8_t RoundKey[176];
+    uint8_t RoundKey[AES_ROUND_KEY_SIZE];
 
     // --- Setup ---
     printf("--- RISC-V AES Performance Sweep ---\n");
 #ifdef USE_RISCV_ACCEL
     const char *mode_str = "Accelerated (Zbb, Zbc)";
     const char *csv_filename = "accelerated_results_aes.csv";
+    const char *batch_csv_filename = "accelerated_batch_results_aes.csv";
 #else
     const char *mode_str = "Standard C (Baseline)";
     const char *csv_filename = "standard_results_aes.csv";
+    const char *batch_csv_filename = "standard_batch_results_aes.csv";
 #endif
     printf("Mode: %s\n", mode_str);
     printf("Workload: Encrypting files from %lld KB to %lld MB.\n", START_SIZE / 1024, END_SIZE / (1024 * 1024));
@@ -335,8 +560,12 @@ int main()
 
     fclose(csv_file);
 
+    printf("\n--- Per-Call vs Batch Sessions Sweep ---\n");
+    if (run_batch_sweep(batch_csv_filename) != 0)
+        return 1;
+
     printf("\n--- Benchmark Sweep Complete ---\n");
-    printf("Results have been saved to '%s'.\n", csv_filename);
+    printf("Results have been saved to '%s' and '%s'.\n", csv_filename, batch_csv_filename);
 
     return 0;
 }
\ No newline at end of file
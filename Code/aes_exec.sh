@@ -10,6 +10,7 @@ echo "accelerated AES encryption test begins"
 
 echo "Moving files from source to AES result directory"
 mv accelerated_results_aes.csv aes_result
+mv accelerated_batch_results_aes.csv aes_result
 mv aes_acc aes_result
 
 #<<<================================================================================================================================================================>>#
@@ -34,6 +35,7 @@ rm temp_data.enc
 
 echo "Moving files from source to AES result directory"
 mv standard_results_aes.csv aes_result
+mv standard_batch_results_aes.csv aes_result
 mv aes aes_result
 
 
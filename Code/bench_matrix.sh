@@ -0,0 +1,164 @@
+#!/bin/bash
+
+#<<<================================================================================================================================================================>>#
+# Cross-ISA benchmark matrix
+#
+# Builds every benchmark variant for each -march/-mabi pair in ISA_MATRIX, runs it under qemu-riscv32 or
+# qemu-riscv64 (picked from the march prefix) and merges all result CSVs into one long-format CSV:
+#
+#   ISA,ABI,Variant,Benchmark,SizeField,Size,Metric,Value
+#
+# Benchmark is the basename of the source CSV (e.g. sha256_standard_resume_results). SizeField is the name of its
+# first column (e.g. FileSize_KB), Size its value.
+#
+# Overrides (environment):
+#   GCC          cross compiler            (default /opt/riscv/bin/riscv64-unknown-linux-gnu-gcc)
+#   QEMU_DIR     directory holding qemu-riscv32 / qemu-riscv64 (default /usr/local/bin)
+#   MATRIX_FILE  file with one "<march> <mabi>" pair per line, replaces ISA_MATRIX
+#   RESULT_DIR   where binaries, raw CSVs and the merged CSV go (default matrix_result)
+#<<<================================================================================================================================================================>>#
+
+GCC=${GCC:-/opt/riscv/bin/riscv64-unknown-linux-gnu-gcc}
+QEMU_DIR=${QEMU_DIR:-/usr/local/bin}
+RESULT_DIR=${RESULT_DIR:-matrix_result}
+MERGED_CSV="$RESULT_DIR/benchmark_matrix.csv"
+
+ISA_MATRIX=(
+    "rv32i ilp32"
+    "rv32i_zbb ilp32"
+    "rv32i_zbb_zbc ilp32"
+    "rv32i_zknh ilp32"
+    "rv32i_zbb_zbc_zbkb_zbkc_zbkx_zknd_zkne_zknh_zksed_zksh ilp32"
+    "rv64gc lp64d"
+    "rv64gc_zbb_zbc lp64d"
+    "rv64gc_zbb_zbc_zbkb_zbkc_zbkx_zknd_zkne_zknh_zksed_zksh lp64d"
+)
+
+if [ -n "$MATRIX_FILE" ]; then
+    mapfile -t ISA_MATRIX < <(grep -v '^\s*\(#\|$\)' "$MATRIX_FILE")
+fi
+
+# "<variant> <source> <define or -> <required extensions or ->"
+# Required extensions: comma separated groups, each group a |-separated list of alternatives.
+VARIANTS=(
+    "sha256_standard sha_dir/sha_filesv2/testv2.c - -"
+    "sha256_accelerated sha_dir/sha_filesv2/testv2.c USE_RISCV_CRYPTO_EXT zknh"
+    "aes_standard aes_dir/aes_filesv2/testv4.c - -"
+    "aes_accelerated aes_dir/aes_filesv2/testv4.c USE_RISCV_ACCEL zbb|zbkb,zbc|zbkc"
+)
+
+#<<<================================================================================================================================================================>>#
+
+# Scalar crypto umbrella extensions and the extensions they imply
+declare -A UMBRELLA_EXTS=(
+    [zk]="zkn zkr zkt zbkb zbkc zbkx zkne zknd zknh"
+    [zkn]="zbkb zbkc zbkx zkne zknd zknh"
+    [zks]="zbkb zbkc zbkx zksed zksh"
+)
+
+# Prints the march extensions one per line, with umbrella extensions expanded
+march_extensions() {
+    local ext
+    [ "$1" = "${1#*_}" ] && return 0
+    IFS='_' read -ra exts <<< "${1#*_}"
+    for ext in "${exts[@]}"; do
+        echo "$ext"
+        [ -n "${UMBRELLA_EXTS[$ext]}" ] && tr ' ' '\n' <<< "${UMBRELLA_EXTS[$ext]}"
+    done
+}
+
+# True if the march string provides every required extension group; otherwise
+# sets MISSING_GROUP to the first group it lacks
+march_supports() {
+    local march=$1 required=$2 group alt found
+    [ "$required" = "-" ] && return 0
+    local provided
+    provided=$(march_extensions "$march")
+    IFS=',' read -ra groups <<< "$required"
+    for group in "${groups[@]}"; do
+        found=0
+        IFS='|' read -ra alts <<< "$group"
+        for alt in "${alts[@]}"; do
+            if grep -qx "$alt" <<< "$provided"; then
+                found=1
+                break
+            fi
+        done
+        if [ $found -eq 0 ]; then
+            MISSING_GROUP=$group
+            return 1
+        fi
+    done
+    return 0
+}
+
+# Appends one raw result CSV to the merged CSV in long format, skipping placeholder columns
+append_long() {
+    local csv=$1 isa=$2 abi=$3 variant=$4
+    local benchmark
+    benchmark=$(basename "$csv" .csv)
+    awk -F, -v prefix="$isa,$abi,$variant,$benchmark" '
+        NR == 1 { for (i = 1; i <= NF; i++) h[i] = $i; next }
+        {
+            for (i = 2; i <= NF; i++)
+                if (h[i] !~ /_Placeholder$/)
+                    print prefix "," h[1] "," $1 "," h[i] "," $i
+        }' "$csv" >> "$MERGED_CSV"
+}
+
+#<<<================================================================================================================================================================>>#
+
+mkdir -p "$RESULT_DIR"
+echo "ISA,ABI,Variant,Benchmark,SizeField,Size,Metric,Value" > "$MERGED_CSV"
+failures=0
+
+for isa_entry in "${ISA_MATRIX[@]}"; do
+    read -r march mabi <<< "$isa_entry"
+    case "$march" in
+        rv32*) qemu="$QEMU_DIR/qemu-riscv32" ;;
+        rv64*) qemu="$QEMU_DIR/qemu-riscv64" ;;
+        *) echo "Skipping unknown ISA '$march'"; failures=$((failures + 1)); continue ;;
+    esac
+
+    for variant_entry in "${VARIANTS[@]}"; do
+        read -r variant source define required <<< "$variant_entry"
+        if ! march_supports "$march" "$required"; then
+            echo "Skipping $variant on $march: missing $MISSING_GROUP"
+            continue
+        fi
+
+        # Keyed on the ABI too, so one march under two ABIs keeps both builds
+        work_dir="$RESULT_DIR/$march-$mabi/$variant"
+        mkdir -p "$work_dir"
+        flags="-march=$march -mabi=$mabi"
+        [ "$define" != "-" ] && flags="$flags -D $define"
+
+        echo "Building $variant for $march ($mabi)"
+        if ! $GCC $flags "$source" -static -o "$work_dir/$variant"; then
+            echo "Build failed for $variant on $march, skipping"
+            failures=$((failures + 1))
+            continue
+        fi
+
+        echo "Running $variant on $march"
+        rm -f "$work_dir"/*.csv
+        if ! (cd "$work_dir" && "$qemu" "./$variant"); then
+            echo "Run failed for $variant on $march"
+            failures=$((failures + 1))
+        fi
+        rm -f "$work_dir/temp_data.bin" "$work_dir/temp_data.enc"
+
+        for csv in "$work_dir"/*.csv; do
+            [ -e "$csv" ] && append_long "$csv" "$march" "$mabi" "$variant"
+        done
+    done
+done
+
+echo "Merged results saved to $MERGED_CSV"
+
+if [ $failures -gt 0 ]; then
+    echo "$failures build/run failure(s): the matrix is incomplete"
+    exit 1
+fi
+
+#<<<================================================================================================================================================================>>#
@@ -0,0 +1,86 @@
+#ifndef CRYPTO_ARENA_H
+#define CRYPTO_ARENA_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*****************************************************************************/
+/* CACHE-LINE-ALIGNED ARENA SHARED BY THE BATCH APIS                         */
+/*****************************************************************************/
+
+// Batch APIs carve their per-session state out of one crypto_arena and take
+// jobs tagged with a session index. Jobs run in order, so sorting them by
+// index keeps the walk over the arena sequential.
+
+// Cache line size used to align and pad everything placed in a crypto_arena
+#define ARENA_ALIGN 64
+
+// Bump allocator over one 64-byte-aligned block; freed all at once
+typedef struct
+{
+    uint8_t *base;
+    size_t size;
+    size_t used;
+} crypto_arena;
+
+static inline size_t arena_round_up(size_t size)
+{
+    return (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+// Reserves size bytes (rounded up to a whole cache line). Returns 0 or -1.
+static inline int arena_init(crypto_arena *arena, size_t size)
+{
+    arena->base = NULL;
+    arena->size = arena->used = 0;
+    if (size > SIZE_MAX - (ARENA_ALIGN - 1))
+        return -1;
+    arena->base = aligned_alloc(ARENA_ALIGN, arena_round_up(size));
+    if (!arena->base)
+        return -1;
+    arena->size = arena_round_up(size);
+    return 0;
+}
+
+// Hands out a cache-line-aligned slice, or NULL when the arena is full or
+// size would overflow when rounded up
+static inline void *arena_alloc(crypto_arena *arena, size_t size)
+{
+    if (size > SIZE_MAX - (ARENA_ALIGN - 1))
+        return NULL;
+    size = arena_round_up(size);
+    if (size > arena->size - arena->used)
+        return NULL;
+    void *p = arena->base + arena->used;
+    arena->used += size;
+    return p;
+}
+
+static inline void arena_reset(crypto_arena *arena)
+{
+    arena->used = 0;
+}
+
+static inline void arena_free(crypto_arena *arena)
+{
+    free(arena->base);
+    arena->base = NULL;
+    arena->size = arena->used = 0;
+}
+
+/*****************************************************************************/
+/* PER-CALL VS BATCH BENCHMARK HELPERS                                       */
+/*****************************************************************************/
+
+typedef struct
+{
+    double per_call_time;
+    double batch_time;
+} BatchResult;
+
+static inline double sessions_per_second(size_t sessions, double seconds)
+{
+    return seconds > 0 ? sessions / seconds : 0.0;
+}
+
+#endif // CRYPTO_ARENA_H
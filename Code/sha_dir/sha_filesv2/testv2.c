@@ -6,10 +6,21 @@
 #include <string.h>
 #include <time.h>
 
+#include "../../common/crypto_arena.h"
+
 // SHA-256 constants
 #define SHA256_BLOCK_SIZE 64
 #define SHA256_DIGEST_SIZE 32
 
+// Serialized context format: magic, version, h[8], len, partial block bytes
+#define SHA256_STATE_MAGIC 0x53323536u // "S256"
+#define SHA256_STATE_VERSION 1
+#define SHA256_STATE_HEADER_SIZE (4 + 1 + 32 + 8)
+#define SHA256_STATE_MAX_SIZE (SHA256_STATE_HEADER_SIZE + SHA256_BLOCK_SIZE - 1)
+
+// Number of slots in the prefix midstate cache
+#define SHA256_MIDSTATE_SLOTS 16
+
 typedef struct
 {
     uint8_t buf[SHA256_BLOCK_SIZE];
@@ -17,6 +28,39 @@ typedef struct
     uint64_t len;
 } sha256_ctx;
 
+// Midstate of a block-aligned prefix, keyed by the SHA-256 digest of that prefix
+typedef struct
+{
+    uint8_t key[SHA256_DIGEST_SIZE];
+    uint32_t h[8];
+    uint64_t len;
+    int used;
+} sha256_midstate;
+
+typedef struct
+{
+    sha256_midstate slots[SHA256_MIDSTATE_SLOTS];
+} sha256_midstate_cache;
+
+// Many SHA-256 contexts laid out structure-of-arrays inside an arena: all
+// chaining values together (two lanes per cache line), all lengths together,
+// and one cache-line-aligned partial block per lane.
+typedef struct
+{
+    size_t count;
+    uint32_t (*h)[8];
+    uint64_t *len;
+    uint8_t (*buf)[SHA256_BLOCK_SIZE];
+} sha256_batch;
+
+// One unit of batched work: absorb len bytes of data into lane ctx
+typedef struct
+{
+    size_t ctx;
+    const uint8_t *data;
+    size_t len;
+} sha256_job;
+
 // Initial hash values for SHA-256
 static const uint32_t sha256_h_init[8] = {
     0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
@@ -44,14 +88,43 @@ static inline uint64_t bswap_64(uint64_t x)
     return ((uint64_t)bswap_32(x) << 32) | bswap_32(x >> 32);
 }
 
-// SHA-256 transform function, processes one 64-byte block
-void sha256_transform(sha256_ctx *ctx, const uint8_t *block);
+// Byte-wise big-endian access, safe for unaligned message and digest buffers
+static inline void store_be32(uint8_t *p, uint32_t x)
+{
+    p[0] = x >> 24;
+    p[1] = x >> 16;
+    p[2] = x >> 8;
+    p[3] = x;
+}
+static inline uint32_t load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// SHA-256 compression function, folds one 64-byte block into state[8]
+void sha256_compress(uint32_t *state, const uint8_t *block);
 
 // --- Public API ---
 void sha256_init(sha256_ctx *ctx);
 void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t len);
 void sha256_final(sha256_ctx *ctx, uint8_t *digest);
 
+// --- Resumable context API ---
+size_t sha256_serialize(const sha256_ctx *ctx, uint8_t *out, size_t out_len);
+int sha256_restore(sha256_ctx *ctx, const uint8_t *in, size_t in_len);
+
+// --- Prefix midstate cache ---
+void sha256_cache_init(sha256_midstate_cache *cache);
+int sha256_cache_put(sha256_midstate_cache *cache, const uint8_t *key, const sha256_ctx *ctx);
+int sha256_cache_get(const sha256_midstate_cache *cache, const uint8_t *key, sha256_ctx *ctx);
+int sha256_cache_register_prefix(sha256_midstate_cache *cache, const uint8_t *prefix, size_t len, uint8_t *key);
+
+// --- Arena-backed batch API ---
+int sha256_batch_init(sha256_batch *batch, crypto_arena *arena, size_t count);
+void sha256_batch_reset(sha256_batch *batch);
+int sha256_batch_update(sha256_batch *batch, const sha256_job *jobs, size_t njobs);
+void sha256_batch_final(sha256_batch *batch, uint8_t *digests);
+
 /*****************************************************************************/
 /* CORE SHA-256 TRANSFORM (STANDARD VS ACCELERATED)                          */
 /*****************************************************************************/
@@ -59,7 +132,7 @@ void sha256_final(sha256_ctx *ctx, uint8_t *digest);
 #ifdef USE_RISCV_CRYPTO_EXT
 
 // ACCELERATED VERSION (using Zksh instructions) - OPTIMIZED
-void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
+void sha256_compress(uint32_t *state, const uint8_t *block)
 {
     uint32_t w[64];
     uint32_t a, b, c, d, e, f, g, h;
@@ -68,7 +141,7 @@ void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
     // 1. Prepare the message schedule array (w[0..63])
     for (int i = 0; i < 16; ++i)
     {
-        w[i] = bswap_32(((uint32_t *)block)[i]);
+        w[i] = load_be32(block + i * 4);
     }
     for (int i = 16; i < 64; ++i)
     {
@@ -80,14 +153,14 @@ void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
         w[i] = w[i - 16] + s0 + w[i - 7] + s1;
     }
 
-    a = ctx->h[0];
-    b = ctx->h[1];
-    c = ctx->h[2];
-    d = ctx->h[3];
-    e = ctx->h[4];
-    f = ctx->h[5];
-    g = ctx->h[6];
-    h = ctx->h[7];
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
 
     // 2. Run the 64 compression rounds
     for (int i = 0; i < 64; ++i)
@@ -114,14 +187,14 @@ void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
         a = t1 + t2;
     }
 
-    ctx->h[0] += a;
-    ctx->h[1] += b;
-    ctx->h[2] += c;
-    ctx->h[3] += d;
-    ctx->h[4] += e;
-    ctx->h[5] += f;
-    ctx->h[6] += g;
-    ctx->h[7] += h;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
 }
 
 #else
@@ -136,7 +209,7 @@ void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
 #define sigma0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
 #define sigma1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
 
-void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
+void sha256_compress(uint32_t *state, const uint8_t *block)
 {
     uint32_t w[64];
     uint32_t a, b, c, d, e, f, g, h;
@@ -144,21 +217,21 @@ void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
 
     for (int i = 0; i < 16; ++i)
     {
-        w[i] = bswap_32(((uint32_t *)block)[i]);
+        w[i] = load_be32(block + i * 4);
     }
     for (int i = 16; i < 64; ++i)
     {
         w[i] = sigma1(w[i - 2]) + w[i - 7] + sigma0(w[i - 15]) + w[i - 16];
     }
 
-    a = ctx->h[0];
-    b = ctx->h[1];
-    c = ctx->h[2];
-    d = ctx->h[3];
-    e = ctx->h[4];
-    f = ctx->h[5];
-    g = ctx->h[6];
-    h = ctx->h[7];
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
 
     for (int i = 0; i < 64; ++i)
     {
@@ -174,14 +247,14 @@ void sha256_transform(sha256_ctx *ctx, const uint8_t *block)
         a = t1 + t2;
     }
 
-    ctx->h[0] += a;
-    ctx->h[1] += b;
-    ctx->h[2] += c;
-    ctx->h[3] += d;
-    ctx->h[4] += e;
-    ctx->h[5] += f;
-    ctx->h[6] += g;
-    ctx->h[7] += h;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
 }
 
 #endif // USE_RISCV_CRYPTO_EXT
@@ -197,65 +270,237 @@ void sha256_init(sha256_ctx *ctx)
     ctx->len = 0;
 }
 
-void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t len)
+// Update and final work on loose (h, buf, len) fields so the same code serves
+// a sha256_ctx and one lane of a sha256_batch.
+static void sha256_absorb(uint32_t *h, uint8_t *buf, uint64_t *total, const uint8_t *data, size_t len)
 {
-    size_t buffer_bytes = ctx->len % SHA256_BLOCK_SIZE;
-    ctx->len += len;
+    size_t buffer_bytes = *total % SHA256_BLOCK_SIZE;
+    *total += len;
 
     if (buffer_bytes > 0)
     {
         size_t to_fill = SHA256_BLOCK_SIZE - buffer_bytes;
         if (len < to_fill)
         {
-            memcpy(ctx->buf + buffer_bytes, data, len);
+            memcpy(buf + buffer_bytes, data, len);
             return;
         }
-        memcpy(ctx->buf + buffer_bytes, data, to_fill);
-        sha256_transform(ctx, ctx->buf);
+        memcpy(buf + buffer_bytes, data, to_fill);
+        sha256_compress(h, buf);
         data += to_fill;
         len -= to_fill;
     }
 
     while (len >= SHA256_BLOCK_SIZE)
     {
-        sha256_transform(ctx, data);
+        sha256_compress(h, data);
         data += SHA256_BLOCK_SIZE;
         len -= SHA256_BLOCK_SIZE;
     }
 
     if (len > 0)
     {
-        memcpy(ctx->buf, data, len);
+        memcpy(buf, data, len);
     }
 }
 
-void sha256_final(sha256_ctx *ctx, uint8_t *digest)
+static void sha256_pad(uint32_t *h, uint8_t *buf, uint64_t total, uint8_t *digest)
 {
-    size_t buffer_bytes = ctx->len % SHA256_BLOCK_SIZE;
+    size_t buffer_bytes = total % SHA256_BLOCK_SIZE;
 
-    ctx->buf[buffer_bytes++] = 0x80;
+    buf[buffer_bytes++] = 0x80;
 
     if (buffer_bytes > SHA256_BLOCK_SIZE - 8)
     {
-        memset(ctx->buf + buffer_bytes, 0, SHA256_BLOCK_SIZE - buffer_bytes);
-        sha256_transform(ctx, ctx->buf);
-        memset(ctx->buf, 0, SHA256_BLOCK_SIZE);
+        memset(buf + buffer_bytes, 0, SHA256_BLOCK_SIZE - buffer_bytes);
+        sha256_compress(h, buf);
+        memset(buf, 0, SHA256_BLOCK_SIZE);
     }
     else
     {
-        memset(ctx->buf + buffer_bytes, 0, SHA256_BLOCK_SIZE - buffer_bytes);
+        memset(buf + buffer_bytes, 0, SHA256_BLOCK_SIZE - buffer_bytes);
     }
 
-    uint64_t bit_len = bswap_64(ctx->len * 8);
-    memcpy(ctx->buf + SHA256_BLOCK_SIZE - 8, &bit_len, 8);
-    sha256_transform(ctx, ctx->buf);
+    uint64_t bit_len = bswap_64(total * 8);
+    memcpy(buf + SHA256_BLOCK_SIZE - 8, &bit_len, 8);
+    sha256_compress(h, buf);
 
     for (int i = 0; i < 8; ++i)
     {
-        ((uint32_t *)digest)[i] = bswap_32(ctx->h[i]);
+        store_be32(digest + i * 4, h[i]);
     }
 }
 
+void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t len)
+{
+    sha256_absorb(ctx->h, ctx->buf, &ctx->len, data, len);
+}
+
+void sha256_final(sha256_ctx *ctx, uint8_t *digest)
+{
+    sha256_pad(ctx->h, ctx->buf, ctx->len, digest);
+}
+
+/*****************************************************************************/
+/* RESUMABLE CONTEXTS (SERIALIZE / RESTORE) AND MIDSTATE CACHE               */
+/*****************************************************************************/
+
+// Writes ctx to out and returns the number of bytes used, or 0 if out is too
+// small. Only the filled part of the partial block is stored. Fields are
+// big-endian so a state saved by an rv32 build can be restored by an rv64
+// build (or the host) and vice versa.
+size_t sha256_serialize(const sha256_ctx *ctx, uint8_t *out, size_t out_len)
+{
+    size_t buffer_bytes = ctx->len % SHA256_BLOCK_SIZE;
+    size_t total = SHA256_STATE_HEADER_SIZE + buffer_bytes;
+    if (out_len < total)
+        return 0;
+
+    store_be32(out, SHA256_STATE_MAGIC);
+    out[4] = SHA256_STATE_VERSION;
+    for (int i = 0; i < 8; ++i)
+        store_be32(out + 5 + i * 4, ctx->h[i]);
+    store_be32(out + 37, (uint32_t)(ctx->len >> 32));
+    store_be32(out + 41, (uint32_t)ctx->len);
+    memcpy(out + SHA256_STATE_HEADER_SIZE, ctx->buf, buffer_bytes);
+    return total;
+}
+
+// Rebuilds ctx from a buffer produced by sha256_serialize. Returns 0 on
+// success, -1 if the buffer is truncated, has the wrong magic or version.
+int sha256_restore(sha256_ctx *ctx, const uint8_t *in, size_t in_len)
+{
+    if (in_len < SHA256_STATE_HEADER_SIZE)
+        return -1;
+    if (load_be32(in) != SHA256_STATE_MAGIC || in[4] != SHA256_STATE_VERSION)
+        return -1;
+
+    uint64_t len = ((uint64_t)load_be32(in + 37) << 32) | load_be32(in + 41);
+    size_t buffer_bytes = len % SHA256_BLOCK_SIZE;
+    if (in_len != SHA256_STATE_HEADER_SIZE + buffer_bytes)
+        return -1;
+
+    for (int i = 0; i < 8; ++i)
+        ctx->h[i] = load_be32(in + 5 + i * 4);
+    ctx->len = len;
+    memset(ctx->buf, 0, sizeof(ctx->buf));
+    memcpy(ctx->buf, in + SHA256_STATE_HEADER_SIZE, buffer_bytes);
+    return 0;
+}
+
+void sha256_cache_init(sha256_midstate_cache *cache)
+{
+    memset(cache, 0, sizeof(*cache));
+}
+
+// Slot index taken from the first key bytes; the key is already a SHA-256
+// digest so it is uniformly distributed.
+static size_t sha256_cache_slot(const uint8_t *key)
+{
+    return load_be32(key) % SHA256_MIDSTATE_SLOTS;
+}
+
+// Stores the midstate of ctx under key. Only block-aligned states are cached
+// (no partial buffer), so a hit can continue straight into sha256_update.
+// A colliding entry is overwritten. Returns 0 on success, -1 if unaligned.
+int sha256_cache_put(sha256_midstate_cache *cache, const uint8_t *key, const sha256_ctx *ctx)
+{
+    if (ctx->len % SHA256_BLOCK_SIZE != 0)
+        return -1;
+
+    sha256_midstate *slot = &cache->slots[sha256_cache_slot(key)];
+    memcpy(slot->key, key, SHA256_DIGEST_SIZE);
+    memcpy(slot->h, ctx->h, sizeof(slot->h));
+    slot->len = ctx->len;
+    slot->used = 1;
+    return 0;
+}
+
+// Loads the midstate stored under key into ctx. Returns 0 on hit, -1 on miss.
+int sha256_cache_get(const sha256_midstate_cache *cache, const uint8_t *key, sha256_ctx *ctx)
+{
+    const sha256_midstate *slot = &cache->slots[sha256_cache_slot(key)];
+    if (!slot->used || memcmp(slot->key, key, SHA256_DIGEST_SIZE) != 0)
+        return -1;
+
+    memcpy(ctx->h, slot->h, sizeof(ctx->h));
+    memset(ctx->buf, 0, sizeof(ctx->buf));
+    ctx->len = slot->len;
+    return 0;
+}
+
+// Hashes a shared prefix once, caches its midstate and writes the cache key
+// (the prefix digest) to key. len must be a multiple of SHA256_BLOCK_SIZE.
+int sha256_cache_register_prefix(sha256_midstate_cache *cache, const uint8_t *prefix, size_t len, uint8_t *key)
+{
+    sha256_ctx ctx;
+    sha256_ctx midstate;
+
+    if (len % SHA256_BLOCK_SIZE != 0)
+        return -1;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, prefix, len);
+    midstate = ctx;
+    sha256_final(&ctx, key);
+    return sha256_cache_put(cache, key, &midstate);
+}
+
+/*****************************************************************************/
+/* ARENA-BACKED BATCH API                                                    */
+/*****************************************************************************/
+
+// Carves count lanes out of the arena and initialises them. Returns 0 or -1.
+int sha256_batch_init(sha256_batch *batch, crypto_arena *arena, size_t count)
+{
+    batch->count = 0;
+    if (count > SIZE_MAX / sizeof(*batch->h) || count > SIZE_MAX / sizeof(*batch->len) ||
+        count > SIZE_MAX / sizeof(*batch->buf))
+        return -1;
+
+    batch->h = arena_alloc(arena, count * sizeof(*batch->h));
+    batch->len = arena_alloc(arena, count * sizeof(*batch->len));
+    batch->buf = arena_alloc(arena, count * sizeof(*batch->buf));
+    if (!batch->h || !batch->len || !batch->buf)
+        return -1;
+    batch->count = count;
+    sha256_batch_reset(batch);
+    return 0;
+}
+
+void sha256_batch_reset(sha256_batch *batch)
+{
+    for (size_t i = 0; i < batch->count; ++i)
+        memcpy(batch->h[i], sha256_h_init, sizeof(batch->h[i]));
+    memset(batch->len, 0, batch->count * sizeof(*batch->len));
+    memset(batch->buf, 0, batch->count * sizeof(*batch->buf));
+}
+
+// Absorbs every job into its lane; several jobs may target the same lane.
+// Returns -1 without touching any lane if a job names a lane outside the batch.
+int sha256_batch_update(sha256_batch *batch, const sha256_job *jobs, size_t njobs)
+{
+    for (size_t j = 0; j < njobs; ++j)
+    {
+        if (jobs[j].ctx >= batch->count)
+            return -1;
+    }
+
+    for (size_t j = 0; j < njobs; ++j)
+    {
+        size_t i = jobs[j].ctx;
+        sha256_absorb(batch->h[i], batch->buf[i], &batch->len[i], jobs[j].data, jobs[j].len);
+    }
+    return 0;
+}
+
+// Finishes every lane, writing count * SHA256_DIGEST_SIZE bytes to digests
+void sha256_batch_final(sha256_batch *batch, uint8_t *digests)
+{
+    for (size_t i = 0; i < batch->count; ++i)
+        sha256_pad(batch->h[i], batch->buf[i], batch->len[i], digests + i * SHA256_DIGEST_SIZE);
+}
+
 /*****************************************************************************/
 /* AUTOMATED BENCHMARKING SUITE                                              */
 /*****************************************************************************/
@@ -322,6 +567,282 @@ PerformanceResult run_benchmark_for_size(long long size)
     return result;
 }
 
+// Resume benchmark: every object shares a block-aligned prefix whose midstate
+// is cached, and the final upload chunk is hashed from a serialized state.
+#define RESUME_PREFIX_SIZE (64 * 1024)
+#define RESUME_CHUNK_SIZE 4096
+
+typedef struct
+{
+    double full_time;
+    double prefix_time;
+    double resume_time;
+} ResumeResult;
+
+// Fills result and returns 0, or returns -1 if the object is too small, a
+// resume step fails or a resumed digest differs from the full rehash.
+int run_resume_benchmark_for_size(long long size, sha256_midstate_cache *cache, const uint8_t *prefix_key,
+                                  ResumeResult *result)
+{
+    if (size < RESUME_PREFIX_SIZE || size < RESUME_CHUNK_SIZE)
+    {
+        fprintf(stderr, "ERROR: %lld KB is smaller than the shared prefix or resume chunk\n", size / 1024);
+        return -1;
+    }
+
+    uint8_t *data = malloc(size);
+    if (!data)
+    {
+        perror("ERROR: Failed to allocate resume buffer");
+        return -1;
+    }
+    for (long long i = 0; i < size; ++i)
+        data[i] = i % 256;
+
+    sha256_ctx ctx;
+    uint8_t full_hash[SHA256_DIGEST_SIZE];
+    uint8_t prefix_hash[SHA256_DIGEST_SIZE];
+    uint8_t resume_hash[SHA256_DIGEST_SIZE];
+    uint8_t saved_state[SHA256_STATE_MAX_SIZE];
+    size_t saved_len;
+    size_t resume_offset = size - RESUME_CHUNK_SIZE;
+
+    // State persisted by an earlier run, just before the last chunk arrived
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, resume_offset);
+    saved_len = sha256_serialize(&ctx, saved_state, sizeof(saved_state));
+
+    // 1. Full rehash from byte 0
+    clock_t start = clock();
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, size);
+    sha256_final(&ctx, full_hash);
+    clock_t end = clock();
+    result->full_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    // 2. Continue from the cached prefix midstate
+    start = clock();
+    if (sha256_cache_get(cache, prefix_key, &ctx) != 0)
+    {
+        fprintf(stderr, "ERROR: Prefix midstate missing from cache\n");
+        free(data);
+        return -1;
+    }
+    sha256_update(&ctx, data + RESUME_PREFIX_SIZE, size - RESUME_PREFIX_SIZE);
+    sha256_final(&ctx, prefix_hash);
+    end = clock();
+    result->prefix_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    // 3. Restore the serialized state and hash only the last chunk
+    start = clock();
+    if (sha256_restore(&ctx, saved_state, saved_len) != 0)
+    {
+        fprintf(stderr, "ERROR: Failed to restore serialized state\n");
+        free(data);
+        return -1;
+    }
+    sha256_update(&ctx, data + resume_offset, RESUME_CHUNK_SIZE);
+    sha256_final(&ctx, resume_hash);
+    end = clock();
+    result->resume_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    if (memcmp(full_hash, prefix_hash, SHA256_DIGEST_SIZE) != 0 ||
+        memcmp(full_hash, resume_hash, SHA256_DIGEST_SIZE) != 0)
+    {
+        fprintf(stderr, "ERROR: Resumed digest differs from full rehash at %lld KB\n", size / 1024);
+        free(data);
+        return -1;
+    }
+
+    free(data);
+    return 0;
+}
+
+static double percent_saved(double full, double partial)
+{
+    return full > 0 ? (full - partial) / full * 100.0 : 0.0;
+}
+
+int run_resume_sweep(long long start_size, long long end_size, long long step_size, const char *csv_filename)
+{
+    sha256_midstate_cache cache;
+    uint8_t prefix[RESUME_PREFIX_SIZE];
+    uint8_t prefix_key[SHA256_DIGEST_SIZE];
+
+    // Same byte pattern as the objects, so the prefix really is shared
+    for (int i = 0; i < RESUME_PREFIX_SIZE; ++i)
+        prefix[i] = i % 256;
+    sha256_cache_init(&cache);
+    if (sha256_cache_register_prefix(&cache, prefix, sizeof(prefix), prefix_key) != 0)
+    {
+        fprintf(stderr, "ERROR: Failed to cache the shared prefix midstate\n");
+        return 1;
+    }
+
+    FILE *csv_file = fopen(csv_filename, "w");
+    if (!csv_file)
+    {
+        perror("ERROR: Could not open resume CSV file for writing");
+        return 1;
+    }
+    fprintf(csv_file, "FileSize_KB,FullRehash_s,PrefixCache_s,ResumeChunk_s,PrefixSaved_pct,ResumeSaved_pct\n");
+
+    // Failed sizes are left out of the CSV and reported through the return value
+    int failed = 0;
+
+    for (long long current_size = start_size; current_size <= end_size; current_size += step_size)
+    {
+        // Objects must at least contain the shared prefix
+        if (current_size < RESUME_PREFIX_SIZE)
+            continue;
+
+        printf("Resume size: %lld KB\r", current_size / 1024);
+        fflush(stdout);
+
+        ResumeResult result;
+        if (run_resume_benchmark_for_size(current_size, &cache, prefix_key, &result) != 0)
+        {
+            failed = 1;
+            continue;
+        }
+
+        fprintf(csv_file, "%lld,%.6f,%.6f,%.6f,%.2f,%.2f\n",
+                current_size / 1024,
+                result.full_time,
+                result.prefix_time,
+                result.resume_time,
+                percent_saved(result.full_time, result.prefix_time),
+                percent_saved(result.full_time, result.resume_time));
+    }
+
+    fclose(csv_file);
+    return failed;
+}
+
+// Batch benchmark: each session hashes one message, either through a fresh
+// stack context per call or as one lane of an arena-backed batch.
+#define BATCH_MSG_SIZE 1024
+#define BATCH_START_SESSIONS 256
+#define BATCH_END_SESSIONS 4096
+#define BATCH_STEP_SESSIONS 256
+
+// Fills result and returns 0, or returns -1 if the batch could not be set up
+// or its output differs from the per-call path.
+int run_batch_benchmark(size_t sessions, crypto_arena *arena, const uint8_t *messages,
+                        uint8_t *per_call_digests, uint8_t *batch_digests, BatchResult *result)
+{
+    sha256_batch batch;
+
+    arena_reset(arena);
+    sha256_job *jobs = arena_alloc(arena, sessions * sizeof(*jobs));
+    if (!jobs || sha256_batch_init(&batch, arena, sessions) != 0)
+    {
+        fprintf(stderr, "ERROR: Arena too small for %zu sessions\n", sessions);
+        return -1;
+    }
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        jobs[i].ctx = i;
+        jobs[i].data = messages + i * BATCH_MSG_SIZE;
+        jobs[i].len = BATCH_MSG_SIZE;
+    }
+
+    // 1. Current path: one context per call
+    clock_t start = clock();
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        sha256_ctx ctx;
+        sha256_init(&ctx);
+        sha256_update(&ctx, messages + i * BATCH_MSG_SIZE, BATCH_MSG_SIZE);
+        sha256_final(&ctx, per_call_digests + i * SHA256_DIGEST_SIZE);
+    }
+    clock_t end = clock();
+    result->per_call_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    // 2. Batched path over the pre-allocated arena
+    start = clock();
+    sha256_batch_reset(&batch);
+    if (sha256_batch_update(&batch, jobs, sessions) != 0)
+    {
+        fprintf(stderr, "ERROR: Batch job names a lane outside the batch\n");
+        return -1;
+    }
+    sha256_batch_final(&batch, batch_digests);
+    end = clock();
+    result->batch_time = ((double)(end - start)) / CLOCKS_PER_SEC;
+
+    if (memcmp(per_call_digests, batch_digests, sessions * SHA256_DIGEST_SIZE) != 0)
+    {
+        fprintf(stderr, "ERROR: Batch digests differ from per-call digests at %zu sessions\n", sessions);
+        return -1;
+    }
+
+    return 0;
+}
+
+int run_batch_sweep(const char *csv_filename)
+{
+    crypto_arena arena;
+    size_t arena_size = BATCH_END_SESSIONS * (sizeof(sha256_job) + 8 * sizeof(uint32_t) + sizeof(uint64_t) +
+                                              SHA256_BLOCK_SIZE) +
+                        4 * ARENA_ALIGN;
+    uint8_t *messages = malloc(BATCH_END_SESSIONS * BATCH_MSG_SIZE);
+    uint8_t *per_call_digests = malloc(BATCH_END_SESSIONS * SHA256_DIGEST_SIZE);
+    uint8_t *batch_digests = malloc(BATCH_END_SESSIONS * SHA256_DIGEST_SIZE);
+    if (!messages || !per_call_digests || !batch_digests || arena_init(&arena, arena_size) != 0)
+    {
+        perror("ERROR: Failed to allocate batch benchmark buffers");
+        free(messages);
+        free(per_call_digests);
+        free(batch_digests);
+        return 1;
+    }
+    for (size_t i = 0; i < BATCH_END_SESSIONS * BATCH_MSG_SIZE; ++i)
+        messages[i] = (i * 7 + i / BATCH_MSG_SIZE) % 256;
+
+    FILE *csv_file = fopen(csv_filename, "w");
+    if (!csv_file)
+    {
+        perror("ERROR: Could not open batch CSV file for writing");
+        arena_free(&arena);
+        free(messages);
+        free(per_call_digests);
+        free(batch_digests);
+        return 1;
+    }
+    fprintf(csv_file, "Sessions,PerCall_s,Batch_s,PerCall_SessionsPerSec,Batch_SessionsPerSec\n");
+
+    // Failed session counts are left out of the CSV and reported through the return value
+    int failed = 0;
+
+    for (size_t sessions = BATCH_START_SESSIONS; sessions <= BATCH_END_SESSIONS; sessions += BATCH_STEP_SESSIONS)
+    {
+        printf("Batch sessions: %zu\r", sessions);
+        fflush(stdout);
+
+        BatchResult result;
+        if (run_batch_benchmark(sessions, &arena, messages, per_call_digests, batch_digests, &result) != 0)
+        {
+            failed = 1;
+            continue;
+        }
+
+        fprintf(csv_file, "%zu,%.6f,%.6f,%.0f,%.0f\n",
+                sessions,
+                result.per_call_time,
+                result.batch_time,
+                sessions_per_second(sessions, result.per_call_time),
+                sessions_per_second(sessions, result.batch_time));
+    }
+
+    fclose(csv_file);
+    arena_free(&arena);
+    free(messages);
+    free(per_call_digests);
+    free(batch_digests);
+    return failed;
+}
+
 int main()
 {
     // Note: SHA-256 is faster than AES, so we can start with a larger step size
@@ -334,9 +855,13 @@ int main()
 #ifdef USE_RISCV_CRYPTO_EXT
     const char *mode_str = "Accelerated (Zksh)";
     const char *csv_filename = "sha256_accelerated_results.csv";
+    const char *resume_csv_filename = "sha256_accelerated_resume_results.csv";
+    const char *batch_csv_filename = "sha256_accelerated_batch_results.csv";
 #else
     const char *mode_str = "Standard C (Baseline)";
     const char *csv_filename = "sha256_standard_results.csv";
+    const char *resume_csv_filename = "sha256_standard_resume_results.csv";
+    const char *batch_csv_filename = "sha256_standard_batch_results.csv";
 #endif
     printf("Mode: %s\n", mode_str);
     printf("Workload: Hashing files from %lld KB to %lld MB.\n", START_SIZE / 1024, END_SIZE / (1024 * 1024));
@@ -364,8 +889,17 @@ int main()
 
     fclose(csv_file);
 
+    printf("\n--- Resume vs Full Rehash Sweep ---\n");
+    if (run_resume_sweep(START_SIZE, END_SIZE, STEP_SIZE, resume_csv_filename) != 0)
+        return 1;
+
+    printf("\n--- Per-Call vs Batch Sessions Sweep ---\n");
+    if (run_batch_sweep(batch_csv_filename) != 0)
+        return 1;
+
     printf("\n--- Benchmark Sweep Complete ---\n");
-    printf("Results have been saved to '%s'.\n", csv_filename);
+    printf("Results have been saved to '%s', '%s' and '%s'.\n", csv_filename, resume_csv_filename,
+           batch_csv_filename);
 
     return 0;
 }
\ No newline at end of file
@@ -10,6 +10,8 @@ echo "accelerated SHA encryption test begins"
 
 echo "Moving files from source to SHA result directory"
 mv sha256_accelerated_results.csv sha_result
+mv sha256_accelerated_resume_results.csv sha_result
+mv sha256_accelerated_batch_results.csv sha_result
 mv sha_acc sha_result
 
 
@@ -35,6 +37,8 @@ echo "Standard SHA encryption test begins"
 
 echo "Moving files from source to SHA result directory"
 mv sha256_standard_results.csv sha_result
+mv sha256_standard_resume_results.csv sha_result
+mv sha256_standard_batch_results.csv sha_result
 mv sha sha_result
 
 #<<<================================================================================================================================================================>>#